@@ -0,0 +1,264 @@
+// Compares two `bench --json` result files and flags regressions.
+//
+// usage: bench_compare <baseline.json> <current.json> [--threshold <percent>]
+//
+// A benchmark regresses when its median ns/op grows by more than the threshold
+// (default 5%) and even its fastest sample is slower than the baseline median,
+// which keeps a few noisy samples from failing the gate. Exit status is 1 if
+// anything regressed, 2 on bad input.
+
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace {
+
+// Just enough JSON for the files bench writes
+struct Value;
+using Array = std::vector<Value>;
+using Object = std::vector<std::pair<std::string, Value>>;
+
+struct Value {
+    std::variant<std::nullptr_t, bool, double, std::string, Array, Object> data;
+
+    [[nodiscard]] const Value* find(const std::string_view key) const {
+        if (const auto* object = std::get_if<Object>(&data)) {
+            for (const auto& [k, v] : *object) {
+                if (k == key) { return &v; }
+            }
+        }
+        return nullptr;
+    }
+
+    [[nodiscard]] double number(const std::string_view key, const double fallback = NAN) const {
+        const Value* v = find(key);
+        const auto* d = v ? std::get_if<double>(&v->data) : nullptr;
+        return d ? *d : fallback;
+    }
+};
+
+class Parser {
+public:
+    explicit Parser(std::string_view text) : text_(text) {}
+
+    Value parse() {
+        Value v = value();
+        skip_ws();
+        if (pos_ != text_.size()) { fail("trailing characters"); }
+        return v;
+    }
+
+private:
+    [[noreturn]] void fail(const char* what) const {
+        throw std::runtime_error(std::string("json: ") + what + " at offset " + std::to_string(pos_));
+    }
+
+    void skip_ws() {
+        while (pos_ < text_.size() && std::isspace(static_cast<unsigned char>(text_[pos_]))) { ++pos_; }
+    }
+
+    bool consume(const char ch) {
+        skip_ws();
+        if (pos_ < text_.size() && text_[pos_] == ch) {
+            ++pos_;
+            return true;
+        }
+        return false;
+    }
+
+    void expect(const char ch) {
+        if (!consume(ch)) { fail("unexpected character"); }
+    }
+
+    bool literal(const std::string_view word) {
+        if (text_.substr(pos_, word.size()) == word) {
+            pos_ += word.size();
+            return true;
+        }
+        return false;
+    }
+
+    Value value() {
+        skip_ws();
+        if (pos_ >= text_.size()) { fail("unexpected end"); }
+
+        const char ch = text_[pos_];
+        if (ch == '{') { return {object()}; }
+        if (ch == '[') { return {array()}; }
+        if (ch == '"') { return {string()}; }
+        if (literal("true")) { return {true}; }
+        if (literal("false")) { return {false}; }
+        if (literal("null")) { return {nullptr}; }
+        return {number()};
+    }
+
+    Object object() {
+        Object object;
+        expect('{');
+        if (consume('}')) { return object; }
+        do {
+            skip_ws();
+            std::string key = string();
+            expect(':');
+            object.emplace_back(std::move(key), value());
+        } while (consume(','));
+        expect('}');
+        return object;
+    }
+
+    Array array() {
+        Array array;
+        expect('[');
+        if (consume(']')) { return array; }
+        do {
+            array.push_back(value());
+        } while (consume(','));
+        expect(']');
+        return array;
+    }
+
+    std::string string() {
+        if (pos_ >= text_.size() || text_[pos_] != '"') { fail("expected string"); }
+        ++pos_;
+
+        std::string out;
+        while (pos_ < text_.size() && text_[pos_] != '"') {
+            char ch = text_[pos_++];
+            if (ch == '\\' && pos_ < text_.size()) {
+                ch = text_[pos_++];
+                switch (ch) {
+                case 'n': ch = '\n'; break;
+                case 't': ch = '\t'; break;
+                case 'u':
+                    // bench only escapes control characters this way
+                    ch = static_cast<char>(std::strtol(std::string(text_.substr(pos_, 4)).c_str(), nullptr, 16));
+                    pos_ += 4;
+                    break;
+                default: break; // '"', '\\', '/'
+                }
+            }
+            out += ch;
+        }
+        if (pos_ >= text_.size()) { fail("unterminated string"); }
+        ++pos_;
+        return out;
+    }
+
+    double number() {
+        const std::string rest(text_.substr(pos_, 64));
+        char* end = nullptr;
+        const double d = std::strtod(rest.c_str(), &end);
+        if (end == rest.c_str()) { fail("expected value"); }
+        pos_ += static_cast<std::size_t>(end - rest.c_str());
+        return d;
+    }
+
+    std::string_view text_;
+    std::size_t pos_ = 0;
+};
+
+struct Entry {
+    double min;
+    double median;
+    double p90;
+    double instructions;
+};
+
+std::map<std::string, Entry> load(const std::string& path) {
+    std::ifstream in(path);
+    if (!in) { throw std::runtime_error("cannot open " + path); }
+    std::stringstream buffer;
+    buffer << in.rdbuf();
+
+    const std::string text = buffer.str();
+    const Value root = Parser(text).parse();
+    const Value* benchmarks = root.find("benchmarks");
+    const auto* list = benchmarks ? std::get_if<Array>(&benchmarks->data) : nullptr;
+    if (list == nullptr) { throw std::runtime_error(path + ": no \"benchmarks\" array"); }
+
+    std::map<std::string, Entry> entries;
+    for (const Value& b : *list) {
+        const Value* name = b.find("name");
+        const Value* stats = b.find("ns_per_op");
+        const Value* counters = b.find("counters");
+        if (name == nullptr || stats == nullptr || !std::holds_alternative<std::string>(name->data)) { continue; }
+
+        entries[std::get<std::string>(name->data)] = {
+            stats->number("min"),
+            stats->number("median"),
+            stats->number("p90"),
+            counters ? counters->number("instructions") : NAN,
+        };
+    }
+    return entries;
+}
+
+double percent(const double before, const double after) {
+    return before > 0 ? (after - before) / before * 100.0 : 0.0;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc != 3 && !(argc == 5 && std::string_view(argv[3]) == "--threshold")) {
+        std::fprintf(stderr, "usage: %s <baseline.json> <current.json> [--threshold <percent>]\n", argv[0]);
+        return 2;
+    }
+    const double threshold = argc == 5 ? std::strtod(argv[4], nullptr) : 5.0;
+
+    std::map<std::string, Entry> baseline;
+    std::map<std::string, Entry> current;
+    try {
+        baseline = load(argv[1]);
+        current = load(argv[2]);
+    } catch (const std::exception& e) {
+        std::fprintf(stderr, "bench_compare: %s\n", e.what());
+        return 2;
+    }
+
+    std::printf("%-44s %12s %12s %9s %9s %9s\n", "benchmark", "base ns/op", "curr ns/op", "median", "p90", "instr");
+
+    int regressions = 0;
+    for (const auto& [name, cur] : current) {
+        const auto it = baseline.find(name);
+        if (it == baseline.end()) {
+            std::printf("%-44s %12s %12.2f   (new)\n", name.c_str(), "-", cur.median);
+            continue;
+        }
+
+        const Entry& base = it->second;
+        const double median = percent(base.median, cur.median);
+        const bool regressed = median > threshold && cur.min > base.median;
+        regressions += regressed ? 1 : 0;
+
+        char instructions[16] = "-";
+        if (!std::isnan(base.instructions) && !std::isnan(cur.instructions)) {
+            std::snprintf(instructions, sizeof instructions, "%+.1f%%", percent(base.instructions, cur.instructions));
+        }
+
+        std::printf("%-44s %12.2f %12.2f %+8.1f%% %+8.1f%% %9s%s\n", name.c_str(), base.median, cur.median,
+                    median, percent(base.p90, cur.p90), instructions, regressed ? "  REGRESSION" : "");
+    }
+
+    for (const auto& [name, base] : baseline) {
+        if (!current.contains(name)) {
+            std::printf("%-44s %12.2f %12s   (missing)\n", name.c_str(), base.median, "-");
+        }
+    }
+
+    if (regressions > 0) {
+        std::printf("\n%d benchmark(s) regressed by more than %.1f%%\n", regressions, threshold);
+        return 1;
+    }
+    return 0;
+}
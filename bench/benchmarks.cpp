@@ -0,0 +1,367 @@
+// Repository-wide benchmarks: one group per top-level example project.
+//
+// usage: bench [--filter <substring>] [--json <file>] [--max-time <ms>]
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <functional>
+#include <list>
+#include <numeric>
+#include <string>
+#include <string_view>
+#include <variant>
+#include <vector>
+
+#include "harness.hpp"
+
+#include "message.hpp"
+#include "message_wire.hpp"
+#include "shapes.hpp"
+#include "role.h"
+
+#if __has_include(<sys/mman.h>)
+#include "journal.h"
+#define BENCH_HAS_JOURNAL 1
+#endif
+
+import tables;
+
+namespace {
+
+void add_match(bench::Runner& runner) {
+    static std::vector<Message> messages;
+    for (int i = 0; i < 1024; ++i) {
+        switch (i % 4) {
+        case 0: messages.push_back(quit()); break;
+        case 1: messages.push_back(move_to(i, -i)); break;
+        case 2: messages.push_back(write("message " + std::to_string(i))); break;
+        default: messages.push_back(read([] {})); break;
+        }
+    }
+
+    runner.add("match/operator>>", [] {
+        long sum = 0;
+        for (const auto& msg : messages) {
+            msg >> oxide::match {
+                [&](const Quit&) { sum += 1; },
+                [&](const Move& m) { sum += m.x + m.y; },
+                [&](const Write& w) { sum += static_cast<long>(w.text.size()); },
+                [&](const Read&) { sum += 2; }
+            };
+        }
+        bench::DoNotOptimize(sum);
+    });
+
+    runner.add("match/ox_match", [] {
+        long sum = 0;
+        for (const auto& msg : messages) {
+            sum += ox_match (
+                ox_match_case(const Quit&) { return 1L; },
+                ox_match_case(const Move& m) { return static_cast<long>(m.x + m.y); },
+                ox_match_case(const Write& w) { return static_cast<long>(w.text.size()); },
+                ox_match_case(const Read&) { return 2L; }
+            ) ox_match_value(msg);
+        }
+        bench::DoNotOptimize(sum);
+    });
+
+    runner.add("match/holds_alternative_chain", [] {
+        long sum = 0;
+        for (const auto& msg : messages) {
+            if (std::holds_alternative<Quit>(msg)) {
+                sum += 1;
+            } else if (const auto* m = std::get_if<Move>(&msg)) {
+                sum += m->x + m->y;
+            } else if (const auto* w = std::get_if<Write>(&msg)) {
+                sum += static_cast<long>(w->text.size());
+            } else {
+                sum += 2;
+            }
+        }
+        bench::DoNotOptimize(sum);
+    });
+
+    // Exactly 90% Move / 10% Write: the workload match/message_dispatch.hpp is generated from
+    static std::vector<Message> move_heavy;
+    for (int i = 0; i < 1000; ++i) {
+        move_heavy.push_back(i % 10 == 0 ? write("message " + std::to_string(i)) : move_to(i, -i));
+    }
+
+    runner.add("match/move_heavy_operator>>", [] {
+        long sum = 0;
+        for (const auto& msg : move_heavy) {
+            msg >> oxide::match {
+                [&](const Quit&) { sum += 1; },
+                [&](const Move& m) { sum += m.x + m.y; },
+                [&](const Write& w) { sum += static_cast<long>(w.text.size()); },
+                [&](const Read&) { sum += 2; }
+            };
+        }
+        bench::DoNotOptimize(sum);
+    });
+
+    // Same matcher through std::visit's table, ignoring the profile
+    runner.add("match/move_heavy_std_visit", [] {
+        long sum = 0;
+        for (const auto& msg : move_heavy) {
+            std::visit(oxide::match {
+                [&](const Quit&) { sum += 1; },
+                [&](const Move& m) { sum += m.x + m.y; },
+                [&](const Write& w) { sum += static_cast<long>(w.text.size()); },
+                [&](const Read&) { sum += 2; }
+            }, msg);
+        }
+        bench::DoNotOptimize(sum);
+    });
+
+    static std::vector<std::byte> encoded;
+    oxide::wire::Encoder encoder(encoded);
+    for (const auto& msg : messages) {
+        oxide::wire::encode(encoder, msg);
+    }
+
+    runner.add("match/wire_encode", [] {
+        static std::vector<std::byte> out;
+        out.clear();
+        oxide::wire::Encoder e(out);
+        for (const auto& msg : messages) {
+            oxide::wire::encode(e, msg);
+        }
+        bench::DoNotOptimize(out.data());
+        bench::ClobberMemory();
+    });
+
+    // Replay straight into a match over borrowed views
+    runner.add("match/wire_decode_views", [] {
+        long sum = 0;
+        oxide::wire::Decoder<Message> decoder(encoded);
+        const auto count = decoder.for_each(oxide::match {
+            [&](const Quit&) { sum += 1; },
+            [&](const Move& m) { sum += m.x + m.y; },
+            [&](const WriteView& w) { sum += static_cast<long>(w.text.size()); },
+            [&](const ReadView&) { sum += 2; }
+        });
+        bench::DoNotOptimize(count);
+        bench::DoNotOptimize(sum);
+    });
+
+    // Baseline: rebuild a std::vector<Message> (copying every string) and dispatch over it
+    runner.add("match/wire_decode_materialize", [] {
+        std::vector<Message> decoded;
+        oxide::wire::Decoder<Message> decoder(encoded);
+        const auto count = decoder.for_each(oxide::match {
+            [&](const Quit&) { decoded.push_back(quit()); },
+            [&](const Move& m) { decoded.push_back(move_to(m.x, m.y)); },
+            [&](const WriteView& w) { decoded.push_back(write(std::string(w.text))); },
+            [&](const ReadView&) { decoded.push_back(read({})); }
+        });
+
+        long sum = 0;
+        for (const auto& msg : decoded) {
+            msg >> oxide::match {
+                [&](const Quit&) { sum += 1; },
+                [&](const Move& m) { sum += m.x + m.y; },
+                [&](const Write& w) { sum += static_cast<long>(w.text.size()); },
+                [&](const Read&) { sum += 2; }
+            };
+        }
+        bench::DoNotOptimize(count);
+        bench::DoNotOptimize(sum);
+    });
+
+    runner.add("match/option_and_then", [] {
+        long sum = 0;
+        for (int i = 0; i < 1024; ++i) {
+            const oxide::Option<int> value = (i & 1) ? oxide::Some(i) : oxide::Option<int>{oxide::None};
+            sum += value.and_then([](const int v) { return oxide::Some(v * 2); }).value_or(-1);
+        }
+        bench::DoNotOptimize(sum);
+    });
+}
+
+void add_covariant_dispatch(bench::Runner& runner) {
+    using ShapeVariant = oxide::Union<Circle, Rectangle>;
+
+    static std::vector<ShapeVariant> shapes;
+    for (int i = 0; i < 1024; ++i) {
+        if (i % 3 == 0) {
+            shapes.emplace_back(Rectangle{static_cast<double>(i), 2.0});
+        } else {
+            shapes.emplace_back(Circle{static_cast<double>(i)});
+        }
+    }
+
+    runner.add("covariant_dispatch/visit_measure", [] {
+        double sum = 0;
+        for (const auto& shape : shapes) {
+            shape >> oxide::match {
+                [&](const Circle& c) { sum += c.area(); },
+                [&](const Rectangle& r) { sum += r.perimeter(); }
+            };
+        }
+        bench::DoNotOptimize(sum);
+    });
+}
+
+struct CountingReaction {
+    long* reactions;
+
+    void react(const Bear& bear, const EnvironmentContext& context) const {
+        *reactions += bear.haveCubs() ? 2 : static_cast<long>(context.season) + 1;
+    }
+};
+
+void add_dci_traits(bench::Runner& runner) {
+    static long reactions = 0;
+    static const AnimalReactionRole role(Bear("Pooh", "American Black Bear"), CountingReaction{&reactions});
+    static const std::array contexts = {
+        EnvironmentContext{Season::Winter, TimeOfDay::Noon},
+        EnvironmentContext{Season::Spring, TimeOfDay::Evening},
+        EnvironmentContext{Season::Summer, TimeOfDay::Night},
+        EnvironmentContext{Season::Autumn, TimeOfDay::Morning},
+    };
+
+    runner.add("dci_traits/role_react", [] {
+        for (const auto& context : contexts) {
+            role.react(context);
+        }
+        bench::DoNotOptimize(reactions);
+    });
+}
+
+void add_reference_wrapper(bench::Runner& runner) {
+    static std::list<int> values(1024);
+    std::iota(values.begin(), values.end(), -512);
+    static const std::vector<std::reference_wrapper<int>> refs(values.begin(), values.end());
+    static const std::vector<int> copies(values.begin(), values.end());
+
+    runner.add("reference_wrapper/sum_through_refs", [] {
+        long sum = 0;
+        for (const int& v : refs) { sum += v; }
+        bench::DoNotOptimize(sum);
+    });
+
+    runner.add("reference_wrapper/sum_contiguous", [] {
+        long sum = 0;
+        for (const int v : copies) { sum += v; }
+        bench::DoNotOptimize(sum);
+    });
+}
+
+void add_generic_programming([[maybe_unused]] bench::Runner& runner) {
+#ifdef BENCH_HAS_JOURNAL
+    static std::vector<std::byte> payload(4096);
+    for (std::size_t i = 0; i < payload.size(); ++i) { payload[i] = static_cast<std::byte>(i * 131); }
+
+    static std::vector<journal::Record> records;
+    for (int i = 0; i < 64; ++i) {
+        records.push_back(journal::make_record("ACC-12345", {true, 100.0 - i, "ACC-12345-TX" + std::to_string(i)}));
+        records.back().lsn = static_cast<std::uint64_t>(i + 1);
+    }
+    static std::vector<std::byte> buffer;
+
+    runner.add("generic_programming/journal_crc32_4k", [] {
+        bench::DoNotOptimize(journal::crc32(payload));
+    });
+
+    runner.add("generic_programming/journal_encode_block_64", [] {
+        journal::encode_block(buffer, records);
+        bench::DoNotOptimize(buffer.data());
+        bench::ClobberMemory();
+    });
+#endif
+}
+
+void add_modules(bench::Runner& runner) {
+    static std::string payload(4096, '\0');
+    for (std::size_t i = 0; i < payload.size(); ++i) { payload[i] = static_cast<char>(i * 131); }
+
+    runner.add("modules/tables_crc32_4k", [] {
+        std::string_view data = payload;
+        bench::DoNotOptimize(data);
+        bench::DoNotOptimize(lookup::crc32(data));
+    });
+
+    runner.add("modules/tables_rule_for", [] {
+        std::uint32_t activities = 0;
+        for (std::size_t s = 0; s < lookup::season_count; ++s) {
+            for (std::size_t t = 0; t < lookup::time_of_day_count; ++t) {
+                activities |= lookup::rule_for(lookup::Animal::Fox, static_cast<Season>(s), static_cast<TimeOfDay>(t)).activities;
+            }
+        }
+        bench::DoNotOptimize(activities);
+    });
+}
+
+std::string now_utc() {
+    const std::time_t now = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+    char buf[32];
+    std::strftime(buf, sizeof buf, "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+    return buf;
+}
+
+std::string compiler() {
+#if defined(__clang__)
+    return "clang " __clang_version__;
+#elif defined(__GNUC__)
+    return "gcc " __VERSION__;
+#elif defined(_MSC_VER)
+    return "msvc " + std::to_string(_MSC_FULL_VER);
+#else
+    return "unknown";
+#endif
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    bench::Options options;
+    std::string json_path;
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view arg = argv[i];
+        if (arg == "--filter" && i + 1 < argc) {
+            options.filter = argv[++i];
+        } else if (arg == "--json" && i + 1 < argc) {
+            json_path = argv[++i];
+        } else if (arg == "--max-time" && i + 1 < argc) {
+            options.max_time = std::chrono::milliseconds(std::strtol(argv[++i], nullptr, 10));
+        } else {
+            std::fprintf(stderr, "usage: %s [--filter <substring>] [--json <file>] [--max-time <ms>]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    bench::Runner runner(options);
+    add_match(runner);
+    add_covariant_dispatch(runner);
+    add_dci_traits(runner);
+    add_reference_wrapper(runner);
+    add_generic_programming(runner);
+    add_modules(runner);
+
+    const bool counters = bench::PerfCounters{}.available();
+    if (!counters) {
+        std::printf("hardware counters unavailable (perf_event_open), reporting timings only\n");
+    }
+
+    const auto results = runner.run();
+
+    if (!json_path.empty()) {
+        const std::vector<std::pair<std::string, std::string>> context = {
+            {"date", now_utc()},
+            {"compiler", compiler()},
+            {"build_type", BENCH_BUILD_TYPE},
+            {"perf_counters", counters ? "true" : "false"},
+        };
+        if (!bench::write_json(json_path, results, context)) {
+            std::fprintf(stderr, "failed to write %s\n", json_path.c_str());
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,265 @@
+#ifndef BENCH_HARNESS_HPP
+#define BENCH_HARNESS_HPP
+
+// Dependency-free micro-benchmark harness.
+//
+// Each case is warmed up, then the batch size is doubled until one batch runs
+// for at least `min_sample_time`; that batch size is kept for every sample so
+// the per-op time is measured well above the clock resolution. Samples are
+// collected until `max_samples` or `max_time` is hit and reduced to min,
+// median, mean, p90, p99 and standard deviation in ns/op.
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "perf_counters.hpp"
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+namespace bench {
+
+// Keeps `value` alive as if something observed it, without emitting a store
+#if defined(__GNUC__) || defined(__clang__)
+template <typename T>
+inline void DoNotOptimize(const T& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+template <typename T>
+inline void DoNotOptimize(T& value) {
+    asm volatile("" : "+r,m"(value) : : "memory");
+}
+
+// Forces pending writes to memory to be treated as observed
+inline void ClobberMemory() {
+    asm volatile("" : : : "memory");
+}
+#else
+namespace detail {
+    inline void use_char_pointer(const volatile char*) {}
+}
+
+template <typename T>
+inline void DoNotOptimize(const T& value) {
+    detail::use_char_pointer(&reinterpret_cast<const volatile char&>(value));
+    _ReadWriteBarrier();
+}
+
+inline void ClobberMemory() {
+    _ReadWriteBarrier();
+}
+#endif
+
+using Clock = std::chrono::steady_clock;
+
+struct Options {
+    std::chrono::milliseconds warmup_time{50};
+    std::chrono::microseconds min_sample_time{2000};
+    std::chrono::milliseconds max_time{500};
+    std::size_t min_samples = 10;
+    std::size_t max_samples = 100;
+    std::string filter;
+};
+
+struct Stats {
+    double min = 0;
+    double median = 0;
+    double mean = 0;
+    double p90 = 0;
+    double p99 = 0;
+    double stddev = 0;
+};
+
+struct Result {
+    std::string name;
+    std::uint64_t iterations_per_sample = 0;
+    std::size_t samples = 0;
+    Stats ns_per_op;
+    std::vector<std::pair<std::string, double>> counters; // per op
+};
+
+// Linear interpolation between closest ranks; `sorted` must be non-empty
+inline double percentile(const std::vector<double>& sorted, const double p) {
+    const double rank = p * static_cast<double>(sorted.size() - 1);
+    const auto lo = static_cast<std::size_t>(rank);
+    const auto hi = std::min(lo + 1, sorted.size() - 1);
+    return sorted[lo] + (sorted[hi] - sorted[lo]) * (rank - static_cast<double>(lo));
+}
+
+inline Stats summarize(std::vector<double> samples) {
+    std::ranges::sort(samples);
+
+    Stats stats;
+    stats.min = samples.front();
+    stats.median = percentile(samples, 0.5);
+    stats.p90 = percentile(samples, 0.9);
+    stats.p99 = percentile(samples, 0.99);
+
+    double sum = 0;
+    for (const double s : samples) { sum += s; }
+    stats.mean = sum / static_cast<double>(samples.size());
+
+    double sq = 0;
+    for (const double s : samples) { sq += (s - stats.mean) * (s - stats.mean); }
+    stats.stddev = samples.size() > 1 ? std::sqrt(sq / static_cast<double>(samples.size() - 1)) : 0.0;
+    return stats;
+}
+
+class Runner {
+public:
+    explicit Runner(Options options = {}) : options_(std::move(options)) {}
+
+    // Registers `op` to be called once per iteration. The loop is instantiated
+    // here so the only indirect call is per batch, not per iteration.
+    template <typename Op>
+    void add(std::string name, Op op) {
+        cases_.push_back({std::move(name), [op = std::move(op)](const std::uint64_t iterations) mutable {
+            for (std::uint64_t i = 0; i < iterations; ++i) {
+                op();
+            }
+        }});
+    }
+
+    std::vector<Result> run() {
+        std::vector<Result> results;
+        for (auto& c : cases_) {
+            if (!options_.filter.empty() && c.name.find(options_.filter) == std::string::npos) { continue; }
+            results.push_back(run_case(c));
+            print(results.back());
+        }
+        return results;
+    }
+
+private:
+    struct Case {
+        std::string name;
+        std::function<void(std::uint64_t)> batch;
+    };
+
+    static Clock::duration time_batch(Case& c, const std::uint64_t iterations) {
+        const auto start = Clock::now();
+        c.batch(iterations);
+        ClobberMemory();
+        return Clock::now() - start;
+    }
+
+    Result run_case(Case& c) {
+        // Warm caches, branch predictors and CPU frequency
+        const auto warmup_end = Clock::now() + options_.warmup_time;
+        std::uint64_t iterations = 1;
+        while (Clock::now() < warmup_end) {
+            time_batch(c, iterations);
+        }
+
+        // Grow the batch until it is long enough to time reliably
+        while (time_batch(c, iterations) < options_.min_sample_time && iterations < (1ull << 40)) {
+            iterations *= 2;
+        }
+
+        std::vector<double> samples;
+        PerfCounters counters;
+        counters.start();
+
+        const auto deadline = Clock::now() + options_.max_time;
+        while (samples.size() < options_.max_samples
+               && (samples.size() < options_.min_samples || Clock::now() < deadline)) {
+            const std::chrono::duration<double, std::nano> elapsed = time_batch(c, iterations);
+            samples.push_back(elapsed.count() / static_cast<double>(iterations));
+        }
+
+        counters.stop();
+
+        Result result;
+        result.name = c.name;
+        result.iterations_per_sample = iterations;
+        result.samples = samples.size();
+        result.ns_per_op = summarize(std::move(samples));
+
+        const double ops = static_cast<double>(iterations) * static_cast<double>(result.samples);
+        for (const auto& [counter, value] : counters.read()) {
+            result.counters.emplace_back(counter, value / ops);
+        }
+        return result;
+    }
+
+    static void print(const Result& r) {
+        std::printf("%-44s %12.2f ns/op  (p90 %10.2f, p99 %10.2f, n=%zu x %llu)",
+                    r.name.c_str(), r.ns_per_op.median, r.ns_per_op.p90, r.ns_per_op.p99,
+                    r.samples, static_cast<unsigned long long>(r.iterations_per_sample));
+        for (const auto& [counter, value] : r.counters) {
+            std::printf("  %s=%.2f", counter.c_str(), value);
+        }
+        std::printf("\n");
+    }
+
+    Options options_;
+    std::vector<Case> cases_;
+};
+
+// Minimal JSON escaping for benchmark names and context strings
+inline std::string json_escape(const std::string_view s) {
+    std::string out;
+    out.reserve(s.size());
+    for (const char ch : s) {
+        switch (ch) {
+        case '"':  out += "\\\""; break;
+        case '\\': out += "\\\\"; break;
+        case '\n': out += "\\n"; break;
+        case '\t': out += "\\t"; break;
+        default:
+            if (static_cast<unsigned char>(ch) < 0x20) {
+                char buf[8];
+                std::snprintf(buf, sizeof buf, "\\u%04x", ch);
+                out += buf;
+            } else {
+                out += ch;
+            }
+        }
+    }
+    return out;
+}
+
+inline bool write_json(const std::string& path, const std::vector<Result>& results,
+                       const std::vector<std::pair<std::string, std::string>>& context) {
+    std::FILE* f = std::fopen(path.c_str(), "w");
+    if (f == nullptr) { return false; }
+
+    std::fprintf(f, "{\n  \"context\": {");
+    for (std::size_t i = 0; i < context.size(); ++i) {
+        std::fprintf(f, "%s\n    \"%s\": \"%s\"", i ? "," : "",
+                     json_escape(context[i].first).c_str(), json_escape(context[i].second).c_str());
+    }
+    std::fprintf(f, "\n  },\n  \"benchmarks\": [");
+
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        const auto& r = results[i];
+        const auto& s = r.ns_per_op;
+        std::fprintf(f, "%s\n    {\n      \"name\": \"%s\",\n      \"iterations_per_sample\": %llu,\n"
+                        "      \"samples\": %zu,\n      \"ns_per_op\": {\"min\": %.4f, \"median\": %.4f, "
+                        "\"mean\": %.4f, \"p90\": %.4f, \"p99\": %.4f, \"stddev\": %.4f},\n      \"counters\": {",
+                     i ? "," : "", json_escape(r.name).c_str(),
+                     static_cast<unsigned long long>(r.iterations_per_sample), r.samples,
+                     s.min, s.median, s.mean, s.p90, s.p99, s.stddev);
+        for (std::size_t k = 0; k < r.counters.size(); ++k) {
+            std::fprintf(f, "%s\"%s\": %.4f", k ? ", " : "", r.counters[k].first.c_str(), r.counters[k].second);
+        }
+        std::fprintf(f, "}\n    }");
+    }
+
+    std::fprintf(f, "\n  ]\n}\n");
+    return std::fclose(f) == 0;
+}
+
+} // namespace bench
+
+#endif // BENCH_HARNESS_HPP
@@ -0,0 +1,106 @@
+#ifndef BENCH_PERF_COUNTERS_HPP
+#define BENCH_PERF_COUNTERS_HPP
+
+// Optional hardware counters via Linux perf_event_open.
+//
+// Each counter is opened on its own so a PMU that lacks one event (or a VM
+// that exposes none) just drops that counter. When perf is unavailable, e.g.
+// perf_event_paranoid forbids it, read() returns nothing and the harness
+// reports timings only. Counts are scaled by time_enabled / time_running to
+// account for multiplexing.
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if defined(__linux__)
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace bench {
+
+class PerfCounters {
+public:
+    PerfCounters() {
+#if defined(__linux__)
+        open("cycles", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+        open("instructions", PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+        open("cache_misses", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES);
+        open("branch_misses", PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES);
+#endif
+    }
+
+    ~PerfCounters() {
+#if defined(__linux__)
+        for (const auto& c : counters_) { ::close(c.fd); }
+#endif
+    }
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    [[nodiscard]] bool available() const { return !counters_.empty(); }
+
+    void start() {
+#if defined(__linux__)
+        for (const auto& c : counters_) {
+            ::ioctl(c.fd, PERF_EVENT_IOC_RESET, 0);
+            ::ioctl(c.fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+#endif
+    }
+
+    void stop() {
+#if defined(__linux__)
+        for (const auto& c : counters_) { ::ioctl(c.fd, PERF_EVENT_IOC_DISABLE, 0); }
+#endif
+    }
+
+    // Totals since start(), by counter name
+    [[nodiscard]] std::vector<std::pair<std::string, double>> read() const {
+        std::vector<std::pair<std::string, double>> values;
+#if defined(__linux__)
+        for (const auto& c : counters_) {
+            std::uint64_t data[3]{}; // value, time_enabled, time_running
+            if (::read(c.fd, data, sizeof data) != static_cast<ssize_t>(sizeof data) || data[2] == 0) { continue; }
+            const double scale = static_cast<double>(data[1]) / static_cast<double>(data[2]);
+            values.emplace_back(c.name, static_cast<double>(data[0]) * scale);
+        }
+#endif
+        return values;
+    }
+
+private:
+    struct Counter {
+        std::string name;
+        int fd;
+    };
+
+#if defined(__linux__)
+    void open(const char* name, const std::uint32_t type, const std::uint64_t config) {
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof attr);
+        attr.size = sizeof attr;
+        attr.type = type;
+        attr.config = config;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+        const int fd = static_cast<int>(::syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+        if (fd >= 0) { counters_.push_back({name, fd}); }
+    }
+#endif
+
+    std::vector<Counter> counters_;
+};
+
+} // namespace bench
+
+#endif // BENCH_PERF_COUNTERS_HPP
@@ -1,22 +1,9 @@
 #include <iostream>
-#include "oxide.hpp"
+#include <variant>
 
-// Define shape types (no inheritance)
-struct Circle {
-    double radius = 1.0;
+#include "shapes.hpp"
 
-    [[nodiscard]] double area() const {
-        return 3.14159 * radius * radius;
-    }
-};
-
-struct Rectangle {
-    double width = 7.0, height = 14.0;
-
-    [[nodiscard]] double perimeter() const {
-        return 2 * (width + height);
-    }
-};
+import oxide;
 
 // Create a discriminated union for shapes
 using ShapeVariant = oxide::Union<Circle, Rectangle>;
@@ -0,0 +1,21 @@
+#ifndef SHAPES_HPP
+#define SHAPES_HPP
+
+// Define shape types (no inheritance)
+struct Circle {
+    double radius = 1.0;
+
+    [[nodiscard]] double area() const {
+        return 3.14159 * radius * radius;
+    }
+};
+
+struct Rectangle {
+    double width = 7.0, height = 14.0;
+
+    [[nodiscard]] double perimeter() const {
+        return 2 * (width + height);
+    }
+};
+
+#endif // SHAPES_HPP
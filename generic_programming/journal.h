@@ -0,0 +1,458 @@
+#ifndef JOURNAL_H
+#define JOURNAL_H
+
+// Append-only write-ahead journal for TransactionResult records.
+//
+// On-disk layout is a sequence of blocks, each one group commit:
+//
+//   [BlockHeader][Record 0][Record 1]...[Record count-1]
+//
+// Records are fixed-size and the CRC covers the header (crc field zeroed) and
+// every record in the block, so a torn or partially written tail block is
+// detected on replay and everything before it is still usable.
+// The format is native-endian; journals are not meant to move between hosts.
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <mutex>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "transaction.h"
+
+namespace journal {
+
+static_assert(std::endian::native == std::endian::little, "crc32 slicing assumes a little-endian host");
+
+// CRC-32 (IEEE 802.3, reflected), slicing-by-8 tables built at compile time.
+// modules/tables.ixx exports the same tables and a constexpr lookup::crc32, but
+// this header stays module-free so generic_programming and journal_bench build
+// without module support. It also loads words with memcpy (hence the
+// little-endian assert above) instead of assembling them byte by byte, since it
+// only runs at runtime on the journal's native-endian blocks.
+inline constexpr auto crc32_tables = [] {
+    std::array<std::array<std::uint32_t, 256>, 8> tables{};
+    for (std::uint32_t i = 0; i < 256; ++i) {
+        std::uint32_t c = i;
+        for (int k = 0; k < 8; ++k) {
+            c = (c & 1u) ? (c >> 1) ^ 0xEDB88320u : c >> 1;
+        }
+        tables[0][i] = c;
+    }
+    for (std::size_t i = 0; i < 256; ++i) {
+        for (std::size_t s = 1; s < tables.size(); ++s) {
+            tables[s][i] = (tables[s - 1][i] >> 8) ^ tables[0][tables[s - 1][i] & 0xFFu];
+        }
+    }
+    return tables;
+}();
+
+inline std::uint32_t crc32(std::span<const std::byte> data, std::uint32_t crc = 0)
+{
+    const auto& t = crc32_tables;
+    const auto* p = reinterpret_cast<const unsigned char*>(data.data());
+    std::size_t n = data.size();
+
+    crc = ~crc;
+    for (; n >= 8; p += 8, n -= 8) {
+        std::uint32_t lo;
+        std::uint32_t hi;
+        std::memcpy(&lo, p, sizeof lo);
+        std::memcpy(&hi, p + 4, sizeof hi);
+        lo ^= crc;
+        crc = t[7][lo & 0xFFu] ^ t[6][(lo >> 8) & 0xFFu] ^ t[5][(lo >> 16) & 0xFFu] ^ t[4][lo >> 24]
+            ^ t[3][hi & 0xFFu] ^ t[2][(hi >> 8) & 0xFFu] ^ t[1][(hi >> 16) & 0xFFu] ^ t[0][hi >> 24];
+    }
+    for (; n > 0; ++p, --n) {
+        crc = (crc >> 8) ^ t[0][(crc ^ *p) & 0xFFu];
+    }
+    return ~crc;
+}
+
+struct Record {
+    std::uint64_t lsn;          // log sequence number, assigned by the Writer
+    double        new_balance;  // balance after the operation
+    char          account[24];  // NUL-padded account id
+    char          tx_id[55];    // NUL-padded transaction id
+    std::uint8_t  success;      // TransactionResult::success
+};
+static_assert(sizeof(Record) == 96, "Record is part of the on-disk format");
+static_assert(std::is_trivially_copyable_v<Record>);
+
+struct BlockHeader {
+    std::uint32_t magic;        // kBlockMagic
+    std::uint32_t count;        // number of records following the header
+    std::uint64_t first_lsn;    // lsn of the first record in the block
+    std::uint32_t crc;          // crc32 over header (crc = 0) and records
+    std::uint32_t reserved;
+};
+static_assert(sizeof(BlockHeader) == 24, "BlockHeader is part of the on-disk format");
+static_assert(std::is_trivially_copyable_v<BlockHeader>);
+
+inline constexpr std::uint32_t kBlockMagic = 0x4C4E524A; // "JRNL"
+
+[[nodiscard]]
+inline auto make_record(std::string_view account, const TransactionResult& result) -> Record
+{
+    Record record{};
+    if (account.size() >= sizeof record.account) { throw std::length_error("Account id too long for journal record"); }
+    if (result.tx_id.size() >= sizeof record.tx_id) { throw std::length_error("Transaction id too long for journal record"); }
+
+    record.new_balance = result.new_balance;
+    record.success = result.success ? 1 : 0;
+    std::ranges::copy(account, record.account);
+    std::ranges::copy(result.tx_id, record.tx_id);
+    return record;
+}
+
+[[nodiscard]] inline std::string_view account_of(const Record& record)
+{
+    return {record.account, ::strnlen(record.account, sizeof record.account)};
+}
+
+[[nodiscard]] inline std::string_view tx_id_of(const Record& record)
+{
+    return {record.tx_id, ::strnlen(record.tx_id, sizeof record.tx_id)};
+}
+
+namespace detail {
+    [[noreturn]] inline void throw_errno(const char* what)
+    {
+        throw std::system_error(errno, std::generic_category(), what);
+    }
+
+    // Owns a file descriptor and closes it on every exit path, so error paths can
+    // throw straight from errno without closing first and clobbering it.
+    class FileDescriptor {
+    public:
+        explicit FileDescriptor(const int fd) : fd_(fd) {}
+        ~FileDescriptor() { if (fd_ >= 0) { ::close(fd_); } }
+
+        FileDescriptor(const FileDescriptor&) = delete;
+        FileDescriptor& operator=(const FileDescriptor&) = delete;
+
+        [[nodiscard]] int get() const { return fd_; }
+
+    private:
+        int fd_;
+    };
+
+    // Makes the directory entry for `path` durable. Without this, a crash can lose
+    // a freshly created journal even though its contents were fdatasync'd.
+    inline void sync_parent_directory(const std::string& path)
+    {
+        auto parent = std::filesystem::path(path).parent_path();
+        if (parent.empty()) { parent = "."; }
+
+        const FileDescriptor dir(::open(parent.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC));
+        if (dir.get() < 0) { throw_errno("journal open directory"); }
+        if (::fsync(dir.get()) != 0) { throw_errno("journal fsync directory"); }
+    }
+
+    inline void write_all(const int fd, const std::byte* data, std::size_t size)
+    {
+        while (size > 0) {
+            const ssize_t n = ::write(fd, data, size);
+            if (n < 0) {
+                if (errno == EINTR) { continue; }
+                throw_errno("journal write");
+            }
+            data += n;
+            size -= static_cast<std::size_t>(n);
+        }
+    }
+
+    inline std::uint32_t block_crc(BlockHeader header, std::span<const Record> records)
+    {
+        header.crc = 0;
+        const auto crc = crc32(std::as_bytes(std::span{&header, 1}));
+        return crc32(std::as_bytes(records), crc);
+    }
+}
+
+// Serializes `records` as one block into `buffer` (reused across calls to avoid reallocating).
+inline void encode_block(std::vector<std::byte>& buffer, std::span<const Record> records)
+{
+    BlockHeader header{kBlockMagic, static_cast<std::uint32_t>(records.size()), records.front().lsn, 0, 0};
+    header.crc = detail::block_crc(header, records);
+
+    buffer.resize(sizeof header + records.size_bytes());
+    std::memcpy(buffer.data(), &header, sizeof header);
+    std::memcpy(buffer.data() + sizeof header, records.data(), records.size_bytes());
+}
+
+// Writes one block and makes it durable. This is the per-record-sync baseline
+// when called with a single record; the Writer calls it once per group commit.
+inline void write_block(const int fd, std::vector<std::byte>& buffer, std::span<const Record> records)
+{
+    encode_block(buffer, records);
+    detail::write_all(fd, buffer.data(), buffer.size());
+    if (::fdatasync(fd) != 0) { detail::throw_errno("journal fdatasync"); }
+}
+
+struct ScanResult {
+    std::size_t   records = 0;      // valid records seen
+    std::size_t   valid_bytes = 0;  // length of the valid prefix of the file
+    std::uint64_t last_lsn = 0;     // lsn of the last valid record, 0 if none
+};
+
+// Memory-maps a journal read-only and walks its blocks sequentially.
+class Reader {
+public:
+    explicit Reader(const std::string& path)
+    {
+        const detail::FileDescriptor fd(::open(path.c_str(), O_RDONLY | O_CLOEXEC));
+        if (fd.get() < 0) { detail::throw_errno("journal open"); }
+
+        struct stat st{};
+        if (::fstat(fd.get(), &st) != 0) { detail::throw_errno("journal fstat"); }
+
+        // The mapping stays valid after fd closes
+        size_ = static_cast<std::size_t>(st.st_size);
+        if (size_ > 0) {
+            void* base = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd.get(), 0);
+            if (base == MAP_FAILED) { detail::throw_errno("journal mmap"); }
+            ::madvise(base, size_, MADV_SEQUENTIAL);
+            data_ = static_cast<const std::byte*>(base);
+        }
+    }
+
+    ~Reader()
+    {
+        if (data_ != nullptr) { ::munmap(const_cast<std::byte*>(data_), size_); }
+    }
+
+    Reader(const Reader&) = delete;
+    Reader& operator=(const Reader&) = delete;
+
+    [[nodiscard]] std::size_t size() const { return size_; }
+
+    // Calls f(const Record&) for every record of every valid block, in lsn order.
+    // Stops at the first block that is truncated or fails its CRC.
+    template <typename F>
+    ScanResult scan(F&& f) const
+    {
+        ScanResult result;
+        std::size_t offset = 0;
+
+        while (size_ - offset >= sizeof(BlockHeader)) {
+            BlockHeader header;
+            std::memcpy(&header, data_ + offset, sizeof header);
+            if (header.magic != kBlockMagic || header.count == 0) { break; }
+
+            const std::size_t body = std::size_t{header.count} * sizeof(Record);
+            if (size_ - offset - sizeof header < body) { break; }
+
+            // Blocks are 8-byte aligned multiples inside a page-aligned mapping.
+            const std::span records{
+                reinterpret_cast<const Record*>(data_ + offset + sizeof header), header.count};
+            if (detail::block_crc(header, records) != header.crc) { break; }
+
+            for (const Record& record : records) {
+                f(record);
+            }
+
+            offset += sizeof header + body;
+            result.records += header.count;
+            result.last_lsn = records.back().lsn;
+        }
+
+        result.valid_bytes = offset;
+        return result;
+    }
+
+    [[nodiscard]] ScanResult scan() const
+    {
+        return scan([](const Record&) {});
+    }
+
+private:
+    const std::byte* data_ = nullptr;
+    std::size_t size_ = 0;
+};
+
+struct StringHash {
+    using is_transparent = void;
+    std::size_t operator()(std::string_view s) const { return std::hash<std::string_view>{}(s); }
+};
+
+using Balances = std::unordered_map<std::string, double, StringHash, std::equal_to<>>;
+
+// Rebuilds the latest balance per account from the successful transactions.
+[[nodiscard]] inline Balances replay_balances(const Reader& reader)
+{
+    Balances balances;
+    reader.scan([&balances](const Record& record) {
+        if (record.success == 0) { return; }
+        const auto account = account_of(record);
+        if (const auto it = balances.find(account); it != balances.end()) {
+            it->second = record.new_balance;
+        } else {
+            balances.emplace(account, record.new_balance);
+        }
+    });
+    return balances;
+}
+
+struct GroupCommitOptions {
+    std::chrono::microseconds interval{200};      // max time a record waits for its batch to close
+    std::size_t               max_batch_bytes = 64 * 1024;  // close the batch early once it holds this much
+};
+
+// Appends records from any number of threads. A background committer drains
+// the pending records into one block and pays a single write + fdatasync per
+// batch, waking every thread waiting on an lsn that batch made durable.
+class Writer {
+public:
+    explicit Writer(const std::string& path, const GroupCommitOptions options = {})
+        : fd_(::open(path.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644))
+        , options_(options)
+    {
+        if (fd_.get() < 0) { detail::throw_errno("journal open"); }
+
+        // Resume after the last valid block and drop any torn tail left by a crash,
+        // otherwise new blocks would land behind data the reader refuses to cross.
+        const Reader reader(path);
+        const ScanResult existing = reader.scan();
+        if (existing.valid_bytes != reader.size()
+            && ::ftruncate(fd_.get(), static_cast<off_t>(existing.valid_bytes)) != 0) {
+            detail::throw_errno("journal ftruncate");
+        }
+
+        // Once per open, before any commit can report durability
+        detail::sync_parent_directory(path);
+
+        next_lsn_ = existing.last_lsn + 1;
+        durable_lsn_ = existing.last_lsn;
+
+        committer_ = std::thread([this] { run(); });
+    }
+
+    ~Writer()
+    {
+        {
+            std::lock_guard lock(mutex_);
+            stopping_ = true;
+        }
+        pending_cv_.notify_one();
+        committer_.join();
+    }
+
+    Writer(const Writer&) = delete;
+    Writer& operator=(const Writer&) = delete;
+
+    // Queues a record for the next group commit and returns its lsn.
+    // The record is not durable until wait_durable(lsn) returns.
+    std::uint64_t append(Record record)
+    {
+        std::unique_lock lock(mutex_);
+        if (error_) { throw std::system_error(error_, "journal committer"); }
+
+        record.lsn = next_lsn_++;
+        pending_.push_back(record);
+        const bool wake = pending_.size() == 1
+            || pending_.size() * sizeof(Record) >= options_.max_batch_bytes;
+        lock.unlock();
+
+        if (wake) { pending_cv_.notify_one(); }
+        return record.lsn;
+    }
+
+    // Blocks until every record up to and including `lsn` is on stable storage.
+    void wait_durable(const std::uint64_t lsn)
+    {
+        std::unique_lock lock(mutex_);
+        durable_cv_.wait(lock, [&] { return durable_lsn_ >= lsn || error_; });
+        if (durable_lsn_ < lsn) { throw std::system_error(error_, "journal committer"); }
+    }
+
+    std::uint64_t commit(const Record& record)
+    {
+        const auto lsn = append(record);
+        wait_durable(lsn);
+        return lsn;
+    }
+
+    [[nodiscard]] std::uint64_t syncs() const { return syncs_.load(std::memory_order_relaxed); }
+
+private:
+    void run()
+    {
+        std::vector<Record> batch;
+        std::vector<std::byte> buffer;
+        std::unique_lock lock(mutex_);
+
+        for (;;) {
+            pending_cv_.wait(lock, [&] { return stopping_ || !pending_.empty(); });
+            if (pending_.empty()) { return; }
+
+            // Give other writers until the interval elapses to join this batch.
+            const auto deadline = std::chrono::steady_clock::now() + options_.interval;
+            pending_cv_.wait_until(lock, deadline, [&] {
+                return stopping_ || pending_.size() * sizeof(Record) >= options_.max_batch_bytes;
+            });
+
+            batch.swap(pending_);
+            lock.unlock();
+
+            std::error_code error;
+            try {
+                write_block(fd_.get(), buffer, batch);
+                syncs_.fetch_add(1, std::memory_order_relaxed);
+            } catch (const std::system_error& e) {
+                error = e.code();
+            }
+
+            lock.lock();
+            if (error) {
+                error_ = error;
+            } else {
+                durable_lsn_ = batch.back().lsn;
+            }
+            batch.clear();
+            durable_cv_.notify_all();
+            if (error_) { return; }
+        }
+    }
+
+    detail::FileDescriptor fd_;
+    GroupCommitOptions options_;
+
+    std::mutex mutex_;
+    std::condition_variable pending_cv_;  // wakes the committer
+    std::condition_variable durable_cv_;  // wakes threads in wait_durable()
+    std::vector<Record> pending_;
+    std::uint64_t next_lsn_ = 1;
+    std::uint64_t durable_lsn_ = 0;
+    std::error_code error_;
+    bool stopping_ = false;
+
+    std::atomic<std::uint64_t> syncs_{0};
+    std::thread committer_;
+};
+
+} // namespace journal
+
+#endif //JOURNAL_H
@@ -0,0 +1,128 @@
+// Compares group commit against one fdatasync per record, then replays the
+// journal through the mmap reader.
+//
+// usage: journal_bench [threads] [records-per-thread] [interval-us] [path]
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "journal.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Run {
+    std::size_t records;
+    std::uint64_t syncs;
+    double seconds;
+};
+
+journal::Record sample_record(const std::size_t thread, const std::size_t i)
+{
+    const std::string account = "ACC-" + std::to_string(10000 + thread);
+    const TransactionResult result{true, 1000.0 - static_cast<double>(i % 1000), account + "-TX" + std::to_string(i)};
+    return journal::make_record(account, result);
+}
+
+// Every record is committed durably before the thread moves on, in both modes,
+// so the comparison is about how many fsyncs that durability costs.
+Run run_per_record(const std::string& path, const std::size_t threads, const std::size_t per_thread)
+{
+    const journal::detail::FileDescriptor fd(::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_APPEND | O_CLOEXEC, 0644));
+    if (fd.get() < 0) { journal::detail::throw_errno("open"); }
+    journal::detail::sync_parent_directory(path);  // as the Writer does
+
+    std::mutex mutex;
+    std::uint64_t lsn = 0;
+    std::vector<std::jthread> workers;
+
+    const auto start = Clock::now();
+    for (std::size_t t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t] {
+            std::vector<std::byte> buffer;
+            for (std::size_t i = 0; i < per_thread; ++i) {
+                auto record = sample_record(t, i);
+                std::lock_guard lock(mutex);
+                record.lsn = ++lsn;
+                journal::write_block(fd.get(), buffer, {&record, 1});
+            }
+        });
+    }
+    workers.clear();
+    const std::chrono::duration<double> elapsed = Clock::now() - start;
+
+    return {threads * per_thread, lsn, elapsed.count()};
+}
+
+Run run_group_commit(const std::string& path, const std::size_t threads, const std::size_t per_thread,
+                     const journal::GroupCommitOptions options)
+{
+    std::remove(path.c_str());
+    journal::Writer writer(path, options);
+    std::vector<std::jthread> workers;
+
+    const auto start = Clock::now();
+    for (std::size_t t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t] {
+            for (std::size_t i = 0; i < per_thread; ++i) {
+                writer.commit(sample_record(t, i));
+            }
+        });
+    }
+    workers.clear();
+    const std::chrono::duration<double> elapsed = Clock::now() - start;
+
+    return {threads * per_thread, writer.syncs(), elapsed.count()};
+}
+
+void report(const char* name, const Run& run)
+{
+    std::printf("%-12s records=%-8zu fsyncs=%-8llu records/sec=%-12.0f fsyncs/sec=%-10.0f records/fsync=%.1f\n",
+                name, run.records, static_cast<unsigned long long>(run.syncs),
+                static_cast<double>(run.records) / run.seconds,
+                static_cast<double>(run.syncs) / run.seconds,
+                static_cast<double>(run.records) / static_cast<double>(run.syncs));
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const std::size_t threads = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 8;
+    const std::size_t per_thread = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 500;
+    const journal::GroupCommitOptions options{
+        std::chrono::microseconds(argc > 3 ? std::strtol(argv[3], nullptr, 10) : journal::GroupCommitOptions{}.interval.count())};
+    const std::string path = argc > 4 ? argv[4] : "journal_bench.dat";
+
+    try {
+        std::cout << "threads=" << threads << " records/thread=" << per_thread
+                  << " interval=" << options.interval.count() << "us path=" << path << "\n";
+
+        report("per-record", run_per_record(path, threads, per_thread));
+        report("group", run_group_commit(path, threads, per_thread, options));
+
+        const auto start = Clock::now();
+        const journal::Reader reader(path);
+        const auto balances = journal::replay_balances(reader);
+        const std::chrono::duration<double> elapsed = Clock::now() - start;
+
+        std::printf("replay       bytes=%-10zu accounts=%-6zu MB/s=%.1f\n", reader.size(), balances.size(),
+                    static_cast<double>(reader.size()) / elapsed.count() / 1e6);
+    } catch (const std::exception& e) {
+        std::cerr << "journal_bench: " << e.what() << '\n';
+        return 1;
+    }
+
+    std::remove(path.c_str());
+    return 0;
+}
@@ -5,11 +5,18 @@
 #include <random>
 #include <chrono>
 
-struct TransactionResult {
-    bool        success;      // true  → transaction applied
-    double      new_balance; // balance after the operation
-    std::string tx_id;       // unique transaction identifier
-};
+#include "transaction.h"
+
+#if __has_include(<sys/mman.h>)
+#include "journal.h"
+#define HAS_JOURNAL 1
+#endif
+
+// __assume is MSVC-only. Not __builtin_assume on Clang: it discards (and warns
+// about) the calls in conditions like !id.empty(); a branch to unreachable keeps them.
+#if !defined(_MSC_VER)
+#define __assume(cond) ((cond) ? static_cast<void>(0) : __builtin_unreachable())
+#endif
 
 inline auto make_rng()
 {
@@ -68,5 +75,28 @@ int main()
     } catch (const std::exception& e) {
         std::cerr << "Transaction failed: " << e.what() << '\n';
     }
+
+#ifdef HAS_JOURNAL
+    // Journal a withdrawal that goes through, then rebuild balances from the file
+    const std::string journal_path = "transactions.journal";
+
+    try {
+        constexpr double balance = 1000.;
+        const auto result = withdraw(balance, 250.0, account);
+        {
+            // Concurrent commits would share one fdatasync via the group-commit writer
+            journal::Writer writer(journal_path);
+            const auto lsn = writer.commit(journal::make_record(account, result));
+            std::cout << "Journaled " << result.tx_id << " as lsn " << lsn << '\n';
+        }
+
+        const journal::Reader reader(journal_path);
+        for (const auto& [acc, bal] : journal::replay_balances(reader)) {
+            std::cout << "Replayed balance " << acc << ": $" << bal << '\n';
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Journal failed: " << e.what() << '\n';
+    }
+#endif
     return 0;
 }
@@ -0,0 +1,12 @@
+#ifndef TRANSACTION_H
+#define TRANSACTION_H
+
+#include <string>
+
+struct TransactionResult {
+    bool        success;      // true  → transaction applied
+    double      new_balance; // balance after the operation
+    std::string tx_id;       // unique transaction identifier
+};
+
+#endif //TRANSACTION_H
@@ -1,22 +1,11 @@
 #include "oxide.hpp"
+#include "message.hpp"
+#include "message_wire.hpp"
 
 #include <functional>
 #include <array>
 #include <iostream>
 
-struct Quit {};  // Unit variant
-struct Move { int x, y; };  // Struct variant
-struct Write { std::string text; };  // Tuple-like (but using struct for named field)
-struct Read { std::function<void()> callback; };  // Variant holding a lambda or function
-
-using Message = oxide::Union<Quit, Move, Write, Read>;
-
-// Non-template factory functions
-constexpr Message quit() { return Message{Quit{}}; }
-constexpr Message move_to(const int x, const int y) { return Message{Move{x, y}}; }
-Message write(std::string text) { return Message{Write{std::move(text)}}; }
-Message read(std::function<void()> callback) { return Message{Read{std::move(callback)}}; }
-
 // Function that might find a message by type (returns Option with copy/move)
 oxide::Option<Message> find_move_message(const std::vector<Message>& messages) {
     for (const auto& msg : messages) {
@@ -137,6 +126,25 @@ int main() {
         process_with_context(msg);
     }
 
+    // Binary round trip: encode the messages, then replay them as borrowed views
+    std::vector<std::byte> wire_bytes;
+    ox::wire::Encoder encoder(wire_bytes);
+    for (const auto& msg : msg_vec) {
+        ox::wire::encode(encoder, msg);
+    }
+
+    std::cout << "\nReplaying " << wire_bytes.size() << " encoded bytes:\n";
+    ox::wire::Decoder<Message> decoder(wire_bytes);
+    const auto replayed = decoder.for_each(ox::match {
+        [](const Quit&) { std::cout << "Replayed quit\n"; },
+        [](const Move& m) { std::cout << "Replayed move: (" << m.x << ", " << m.y << ")\n"; },
+        [](const WriteView& w) { std::cout << "Replayed write: " << w.text << "\n"; },
+        [](const ReadView&) { std::cout << "Replayed read (callback not persisted)\n"; }
+    });
+    if (!replayed) {
+        std::cout << "Replay failed at byte " << decoder.value_offset() << "\n";
+    }
+
     // Rust-like example with std::expected (built-in monadic ops: and_then, transform, etc.)
     auto divide = [](const int a, const int b) -> Result<int> {
         if (b == 0) return std::unexpected("Division by zero");
@@ -0,0 +1,28 @@
+#ifndef MESSAGE_HPP
+#define MESSAGE_HPP
+
+#include <functional>
+#include <string>
+#include <utility>
+
+#include "oxide.hpp"
+
+struct Quit {};  // Unit variant
+struct Move { int x, y; };  // Struct variant
+struct Write { std::string text; };  // Tuple-like (but using struct for named field)
+struct Read { std::function<void()> callback; };  // Variant holding a lambda or function
+
+using Message = oxide::Union<Quit, Move, Write, Read>;
+
+// Non-template factory functions
+constexpr Message quit() { return Message{Quit{}}; }
+constexpr Message move_to(const int x, const int y) { return Message{Move{x, y}}; }
+inline Message write(std::string text) { return Message{Write{std::move(text)}}; }
+inline Message read(std::function<void()> callback) { return Message{Read{std::move(callback)}}; }
+
+// Move-first dispatch order from a profile of a 90% Move stream. Regenerate it
+// from a build configured with -DOXIDE_PROFILE_DISPATCH=ON:
+//   OXIDE_PROFILE_HEADER=match/message_dispatch.hpp bench --filter match/move_heavy_operator
+#include "message_dispatch.hpp"
+
+#endif // MESSAGE_HPP
@@ -0,0 +1,17 @@
+// Generated by an OXIDE_PROFILE_DISPATCH run. Include after oxide.hpp (or import oxide;)
+// and the Union types below are declared, in every translation unit that dispatches
+// on them. Module consumers include <array> and <cstddef> before the import.
+
+#ifndef OXIDE_DISPATCH_PROFILE_HPP
+#define OXIDE_DISPATCH_PROFILE_HPP
+
+#include <array>
+#include <cstddef>
+
+template <>
+struct oxide::dispatch_order<std::variant<Quit, Move, Write, Read>> {
+    // Move: 90.0%
+    static constexpr std::array<std::size_t, 1> hot{1};
+};
+
+#endif // OXIDE_DISPATCH_PROFILE_HPP
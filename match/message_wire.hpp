@@ -0,0 +1,57 @@
+#ifndef MESSAGE_WIRE_HPP
+#define MESSAGE_WIRE_HPP
+
+#include <string_view>
+
+#include "message.hpp"
+#include "oxide_wire.hpp"
+
+// Wire form of Message. Decoding hands out views into the encoded buffer:
+// Quit and Move decode to themselves, Write to a WriteView whose text borrows
+// the buffer, and Read to a ReadView since callbacks are process-local and
+// have to be re-bound by whoever replays the stream.
+
+struct WriteView { std::string_view text; };
+struct ReadView {};
+
+template <>
+struct oxide::wire::codec<Quit> {
+    using view = Quit;
+    static void encode(Encoder&, const Quit&) {}
+    static Option<view> decode(Cursor&) { return Some(Quit{}); }
+};
+
+template <>
+struct oxide::wire::codec<Move> {
+    using view = Move;
+
+    static void encode(Encoder& e, const Move& m) {
+        e.zigzag(m.x);
+        e.zigzag(m.y);
+    }
+
+    static Option<view> decode(Cursor& c) {
+        const auto x = c.zigzag_as<int>();
+        const auto y = c.zigzag_as<int>();
+        if (!x || !y) { return None; }
+        return Some(Move{*x, *y});
+    }
+};
+
+template <>
+struct oxide::wire::codec<Write> {
+    using view = WriteView;
+    static void encode(Encoder& e, const Write& w) { e.string(w.text); }
+    static Option<view> decode(Cursor& c) {
+        return c.string().transform([](const std::string_view text) { return WriteView{text}; });
+    }
+};
+
+template <>
+struct oxide::wire::codec<Read> {
+    using view = ReadView;
+    static void encode(Encoder&, const Read&) {}
+    static Option<view> decode(Cursor&) { return Some(ReadView{}); }
+};
+
+#endif // MESSAGE_WIRE_HPP
@@ -1,5 +1,6 @@
 import hello;
 import scopes;
+import tables;
 
 #ifdef _MSC_VER
 #include <iostream>
@@ -19,5 +20,11 @@ int main()
                  " Life, The Universe, and Everything is "
                  << answer << "\n";
 
+    // Computed by the compiler from the module's exported CRC table
+    constexpr auto checksum = lookup::crc32("The quick brown fox jumps over the lazy dog");
+    static_assert(checksum == 0x414FA339u);
+
+    std::cout << "CRC-32 of the quick brown fox: 0x" << std::hex << checksum << std::dec << "\n";
+
     return 0;
 }
@@ -0,0 +1,158 @@
+module;
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include "domain.h"
+
+export module tables;
+
+// Lookup tables computed by the compiler and exported as constants.
+// Every table is an `inline constexpr std::array`, so it is constant-initialized
+// into read-only data: no code runs at startup to fill it, and every importer
+// shares the single definition. The make_* generators stay constexpr (not
+// consteval) so tables_startup_bench can run the very same code at runtime.
+
+export namespace lookup {
+    // CRC-32 slicing-by-8 tables for a reflected polynomial
+    using CrcTables = std::array<std::array<std::uint32_t, 256>, 8>;
+
+    constexpr CrcTables make_crc_tables(const std::uint32_t polynomial) {
+        CrcTables tables{};
+        for (std::uint32_t i = 0; i < 256; ++i) {
+            std::uint32_t c = i;
+            for (int k = 0; k < 8; ++k) {
+                c = (c & 1u) ? (c >> 1) ^ polynomial : c >> 1;
+            }
+            tables[0][i] = c;
+        }
+        for (std::size_t i = 0; i < 256; ++i) {
+            for (std::size_t s = 1; s < tables.size(); ++s) {
+                tables[s][i] = (tables[s - 1][i] >> 8) ^ tables[0][tables[s - 1][i] & 0xFFu];
+            }
+        }
+        return tables;
+    }
+
+    inline constexpr std::uint32_t crc32_polynomial  = 0xEDB88320u; // IEEE 802.3
+    inline constexpr std::uint32_t crc32c_polynomial = 0x82F63B78u; // Castagnoli
+
+    inline constexpr CrcTables crc32_table  = make_crc_tables(crc32_polynomial);
+    inline constexpr CrcTables crc32c_table = make_crc_tables(crc32c_polynomial);
+
+    // Slicing-by-8: eight bytes per step through all eight tables, then the
+    // tail a byte at a time. Words are assembled from bytes (not memcpy'd) so
+    // it stays constexpr and endian-independent.
+    constexpr std::uint32_t crc32(const std::string_view data, const CrcTables& table = crc32_table) {
+        const auto byte = [&](const std::size_t i) { return std::uint32_t{static_cast<unsigned char>(data[i])}; };
+        const auto word = [&](const std::size_t i) {
+            return byte(i) | byte(i + 1) << 8 | byte(i + 2) << 16 | byte(i + 3) << 24;
+        };
+
+        std::uint32_t crc = ~0u;
+        std::size_t i = 0;
+        for (; data.size() - i >= 8; i += 8) {
+            const std::uint32_t lo = word(i) ^ crc;
+            const std::uint32_t hi = word(i + 4);
+            crc = table[7][lo & 0xFFu] ^ table[6][(lo >> 8) & 0xFFu] ^ table[5][(lo >> 16) & 0xFFu] ^ table[4][lo >> 24]
+                ^ table[3][hi & 0xFFu] ^ table[2][(hi >> 8) & 0xFFu] ^ table[1][(hi >> 16) & 0xFFu] ^ table[0][hi >> 24];
+        }
+        for (; i < data.size(); ++i) {
+            crc = (crc >> 8) ^ table[0][(crc ^ byte(i)) & 0xFFu];
+        }
+        return ~crc;
+    }
+
+    // Bit count of every 16-bit value (64 KiB)
+    using PopcountTable = std::array<std::uint8_t, 1u << 16>;
+
+    constexpr PopcountTable make_popcount_table() {
+        PopcountTable table{};
+        for (std::size_t i = 1; i < table.size(); ++i) {
+            table[i] = static_cast<std::uint8_t>(table[i >> 1] + (i & 1u));
+        }
+        return table;
+    }
+
+    inline constexpr PopcountTable popcount16_table = make_popcount_table();
+
+    // Season x TimeOfDay reaction rules for the DCI traits animals.
+    // Time of day does not change the rules yet; the dimension is there so it
+    // can without changing how callers look a rule up.
+    enum class Animal {
+        Bear,
+        Fox,
+    };
+
+    struct Rule {
+        Location      location;
+        std::uint32_t activities;  // one bit per Activity
+    };
+
+    constexpr std::uint32_t bit(const Activity activity) {
+        return 1u << static_cast<unsigned>(activity);
+    }
+
+    constexpr bool does(const Rule& rule, const Activity activity) {
+        return (rule.activities & bit(activity)) != 0;
+    }
+
+    constexpr Rule make_rule(const Animal animal, const Season season, TimeOfDay) {
+        switch (animal) {
+        case Animal::Bear:
+            switch (season) {
+            case Season::Winter: return {Location::Den,     bit(Activity::Hibernating)};
+            case Season::Spring: return {Location::Roaming, bit(Activity::Marking)};
+            case Season::Summer: return {Location::Roaming, bit(Activity::Foraging) | bit(Activity::Fishing)};
+            case Season::Autumn: return {Location::Roaming, bit(Activity::Foraging)};
+            }
+            break;
+        case Animal::Fox:
+            switch (season) {
+            case Season::Winter: return {Location::Roaming, bit(Activity::Scavenging) | bit(Activity::Hunting)};
+            case Season::Spring: return {Location::Roaming, bit(Activity::Hunting)};
+            case Season::Summer: return {Location::Roaming, bit(Activity::Socializing) | bit(Activity::Marking) | bit(Activity::Hunting)};
+            case Season::Autumn: return {Location::Roaming, bit(Activity::Hunting)};
+            }
+            break;
+        }
+        return {Location::Roaming, 0};
+    }
+
+    inline constexpr std::size_t animal_count = 2;
+    inline constexpr std::size_t season_count = 4;
+    inline constexpr std::size_t time_of_day_count = 4;
+
+    using RuleMatrix = std::array<std::array<std::array<Rule, time_of_day_count>, season_count>, animal_count>;
+
+    constexpr RuleMatrix make_rule_matrix() {
+        RuleMatrix matrix{};
+        for (std::size_t a = 0; a < animal_count; ++a) {
+            for (std::size_t s = 0; s < season_count; ++s) {
+                for (std::size_t t = 0; t < time_of_day_count; ++t) {
+                    matrix[a][s][t] = make_rule(static_cast<Animal>(a), static_cast<Season>(s), static_cast<TimeOfDay>(t));
+                }
+            }
+        }
+        return matrix;
+    }
+
+    inline constexpr RuleMatrix rule_matrix = make_rule_matrix();
+
+    constexpr const Rule& rule_for(const Animal animal, const Season season, const TimeOfDay time_of_day) {
+        return rule_matrix[static_cast<std::size_t>(animal)]
+                          [static_cast<std::size_t>(season)]
+                          [static_cast<std::size_t>(time_of_day)];
+    }
+}
+
+// Known-answer checks, evaluated once when the module is compiled
+static_assert(lookup::crc32_table[0][1] == 0x77073096u);
+static_assert(lookup::crc32("123456789") == 0xCBF43926u);
+static_assert(lookup::crc32("123456789", lookup::crc32c_table) == 0xE3069283u);
+static_assert(lookup::crc32("The quick brown fox jumps over the lazy dog") == 0x414FA339u);
+static_assert(lookup::popcount16_table[0xFFFF] == 16);
+static_assert(lookup::rule_for(lookup::Animal::Bear, Season::Winter, TimeOfDay::Noon).location == Location::Den);
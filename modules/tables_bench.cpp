@@ -0,0 +1,116 @@
+// Startup cost of lookup tables: exported constexpr tables from the `tables`
+// module versus the same tables filled by dynamic initialization before main().
+//
+// The runtime tables are built by the module's own make_* functions. The CRC
+// polynomials are read through volatile, and the generators that take no input
+// are called through volatile function pointers, so the compiler can't fold
+// any of them back into constants.
+//
+// Writing the runtime tables during init already faults their pages in, so
+// reading them afterwards is cheap; the constexpr tables pay their .rodata
+// faults on first read instead. The comparison is therefore runtime init plus
+// first read against constexpr first read: the full cost of each approach
+// before a program can use its tables.
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+#include "domain.h"
+
+import tables;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+volatile std::uint32_t crc32_polynomial  = lookup::crc32_polynomial;
+volatile std::uint32_t crc32c_polynomial = lookup::crc32c_polynomial;
+
+lookup::PopcountTable (*volatile make_popcount_table)() = lookup::make_popcount_table;
+lookup::RuleMatrix (*volatile make_rule_matrix)() = lookup::make_rule_matrix;
+
+namespace runtime {
+    lookup::CrcTables crc32_table;
+    lookup::CrcTables crc32c_table;
+    lookup::PopcountTable popcount16_table;
+    lookup::RuleMatrix rule_matrix;
+}
+
+// Runs during dynamic initialization, the way a service fills its tables at startup
+struct RuntimeInit {
+    Clock::duration elapsed{};
+
+    RuntimeInit() {
+        const auto start = Clock::now();
+        runtime::crc32_table = lookup::make_crc_tables(crc32_polynomial);
+        runtime::crc32c_table = lookup::make_crc_tables(crc32c_polynomial);
+        runtime::popcount16_table = make_popcount_table();
+        runtime::rule_matrix = make_rule_matrix();
+        elapsed = Clock::now() - start;
+    }
+};
+
+const RuntimeInit runtime_init;
+
+// Reads every byte, so tables not yet resident fault in during the measurement
+template <typename Table>
+std::uint64_t checksum(const Table& table) {
+    const auto* bytes = reinterpret_cast<const unsigned char*>(&table);
+    std::uint64_t sum = 0;
+    for (std::size_t i = 0; i < sizeof(Table); ++i) {
+        sum = sum * 31 + bytes[i];
+    }
+    return sum;
+}
+
+std::uint64_t checksum_constexpr() {
+    return checksum(lookup::crc32_table) ^ checksum(lookup::crc32c_table)
+         ^ checksum(lookup::popcount16_table) ^ checksum(lookup::rule_matrix);
+}
+
+std::uint64_t checksum_runtime() {
+    return checksum(runtime::crc32_table) ^ checksum(runtime::crc32c_table)
+         ^ checksum(runtime::popcount16_table) ^ checksum(runtime::rule_matrix);
+}
+
+double micros(const Clock::duration d) {
+    return std::chrono::duration<double, std::micro>(d).count();
+}
+
+} // namespace
+
+int main() {
+    constexpr std::size_t bytes = sizeof(lookup::CrcTables) * 2 + sizeof(lookup::PopcountTable) + sizeof(lookup::RuleMatrix);
+
+    auto start = Clock::now();
+    const auto constexpr_sum = checksum_constexpr();
+    const auto constexpr_touch = Clock::now() - start;
+
+    start = Clock::now();
+    const auto runtime_sum = checksum_runtime();
+    const auto runtime_touch = Clock::now() - start;
+
+    // Steady-state rebuild cost, i.e. what every process start pays again
+    constexpr int rebuilds = 100;
+    start = Clock::now();
+    for (int i = 0; i < rebuilds; ++i) {
+        const RuntimeInit again;
+    }
+    const auto rebuild = (Clock::now() - start) / rebuilds;
+
+    std::printf("tables: %zu bytes\n", bytes);
+    std::printf("constexpr (.rodata): init %8.1f us + first read %8.1f us = ready in %8.1f us\n",
+                0.0, micros(constexpr_touch), micros(constexpr_touch));
+    std::printf("runtime   (.bss)   : init %8.1f us + first read %8.1f us = ready in %8.1f us (warm rebuild %.1f us)\n",
+                micros(runtime_init.elapsed), micros(runtime_touch), micros(runtime_init.elapsed + runtime_touch),
+                micros(rebuild));
+
+    if (constexpr_sum != runtime_sum) {
+        std::printf("table mismatch between constexpr and runtime builds\n");
+        return 1;
+    }
+    return 0;
+}
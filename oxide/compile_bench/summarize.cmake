@@ -0,0 +1,56 @@
+# Sums the Clang -ftime-trace totals of every object in the header and module
+# stress targets' object directories, plus the oxide.ixx interface compiled in
+# the oxide target, which only the module side depends on.
+# Usage: cmake -DHEADER_DIR=<dir> -DMODULE_DIR=<dir> -DINTERFACE_DIR=<dir> -P summarize.cmake
+#
+# GCC writes no -ftime-trace JSON; its compiles are timed by the `cmake -E time`
+# lines in the build log only.
+
+set(phases "ExecuteCompiler" "Frontend" "Source" "InstantiateClass" "InstantiateFunction" "Backend")
+
+# Sets <prefix>_count and <prefix>_<phase> (microseconds) from the traces under `dir`
+function(oxide_sum_traces dir prefix)
+    file(GLOB_RECURSE traces "${dir}/*.cpp.json" "${dir}/*.ixx.json")
+    list(LENGTH traces count)
+    set(${prefix}_count ${count} PARENT_SCOPE)
+
+    foreach(phase IN LISTS phases)
+        set(total 0)
+        foreach(trace IN LISTS traces)
+            file(READ "${trace}" json)
+            # Clang writes: ...,"dur":<us>,"name":"Total <phase>",...
+            if(json MATCHES "\"dur\":([0-9]+),\"name\":\"Total ${phase}\"")
+                math(EXPR total "${total} + ${CMAKE_MATCH_1}")
+            endif()
+        endforeach()
+        set(${prefix}_${phase} ${total} PARENT_SCOPE)
+    endforeach()
+endfunction()
+
+function(oxide_print_totals label prefix)
+    set(line "${label} (${${prefix}_count} TUs):")
+    foreach(phase IN LISTS phases)
+        math(EXPR ms "${${prefix}_${phase}} / 1000")
+        string(APPEND line " ${phase}=${ms}ms")
+    endforeach()
+    message(STATUS "${line}")
+endfunction()
+
+oxide_sum_traces("${HEADER_DIR}" header)
+oxide_sum_traces("${MODULE_DIR}" module)
+oxide_sum_traces("${INTERFACE_DIR}" interface)
+
+if(header_count EQUAL 0 AND module_count EQUAL 0)
+    message(STATUS "No -ftime-trace output (not Clang?): compare the `cmake -E time` lines in the build log")
+    return()
+endif()
+
+math(EXPR total_count "${module_count} + ${interface_count}")
+foreach(phase IN LISTS phases)
+    math(EXPR total_${phase} "${module_${phase}} + ${interface_${phase}}")
+endforeach()
+
+oxide_print_totals("header: oxide_stress_header" header)
+oxide_print_totals("module: oxide_stress_module" module)
+oxide_print_totals("module: oxide.ixx interface" interface)
+oxide_print_totals("module: total" total)
@@ -29,8 +29,21 @@
 #include <expected>
 #include <optional>
 #include <vector>
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <type_traits>
 
-namespace oxide {
+#ifdef OXIDE_PROFILE_DISPATCH
+#include "oxide_profile.hpp"
+#endif
+
+// oxide.ixx defines this as `export` so the module exports the same declarations
+#ifndef OXIDE_EXPORT
+#define OXIDE_EXPORT
+#endif
+
+OXIDE_EXPORT namespace oxide {
     template<typename T>
     using Option = std::optional<T>;
 
@@ -40,7 +53,7 @@ namespace oxide {
         return std::make_optional(std::forward<T>(value));
     }
 
-    constexpr std::nullopt_t None = std::nullopt;
+    inline constexpr std::nullopt_t None = std::nullopt;
 
     // Vector type
     template<typename T>
@@ -56,9 +69,46 @@ namespace oxide {
         using Handlers::operator()...;
     };
 
+    // Profile-guided dispatch order: alternative indices that operator>> tests
+    // first, most frequent first, before falling back to std::visit's table.
+    // Specialize per Union, or generate the specializations with an
+    // OXIDE_PROFILE_DISPATCH run (see oxide_profile.hpp).
+    template <typename Variant>
+    struct dispatch_order {
+        static constexpr std::array<std::size_t, 0> hot{};
+    };
+
+    namespace detail {
+        template <std::size_t K, typename Variant, typename Matcher>
+        bool dispatch_hot(Variant&& v, Matcher& m) {
+            constexpr auto& hot = dispatch_order<std::remove_cvref_t<Variant>>::hot;
+            if constexpr (K == hot.size()) {
+                return false;
+            } else {
+                constexpr std::size_t I = hot[K];
+                if constexpr (K == 0) {
+                    if (v.index() == I) [[likely]] {
+                        std::invoke(m, std::get<I>(std::forward<Variant>(v)));
+                        return true;
+                    }
+                } else if (v.index() == I) {
+                    std::invoke(m, std::get<I>(std::forward<Variant>(v)));
+                    return true;
+                }
+                return dispatch_hot<K + 1>(std::forward<Variant>(v), m);
+            }
+        }
+    }
+
     // Overload >> for visitation (as in your history)
     template <typename Variant, typename Matcher>
     void operator>>(Variant&& v, Matcher&& m) {
+#ifdef OXIDE_PROFILE_DISPATCH
+        profile::record<std::remove_cvref_t<Variant>, std::remove_cvref_t<Matcher>>(v.index());
+#endif
+        if constexpr (dispatch_order<std::remove_cvref_t<Variant>>::hot.size() > 0) {
+            if (detail::dispatch_hot<0>(std::forward<Variant>(v), m)) { return; }
+        }
         std::visit(std::forward<Matcher>(m), std::forward<Variant>(v));
     }
 
@@ -73,9 +123,7 @@ namespace oxide {
     using Result = std::expected<T, E>;
 }
 
-// Macro-based match syntax for a more Rust-like feel (inspired by common emulations)
-#define ox_match std::visit([](auto&&... args) { return oxide::overloaded{std::forward<decltype(args)>(args)...}; }
-#define ox_match_case(param) [](param)
-#define ox_match_value(value) , std::forward<decltype(value)>(value))
+// ox_match macros live in a companion header so `import oxide;` users can include them too
+#include "oxide_match.hpp"
 
-#endif // OXIDE_HPP
\ No newline at end of file
+#endif // OXIDE_HPP
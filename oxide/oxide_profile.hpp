@@ -0,0 +1,247 @@
+/*
+    Copyright (C) 2025 Igal Alkon <igal@alkontek.com> and contributors
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef OXIDE_PROFILE_HPP
+#define OXIDE_PROFILE_HPP
+
+// Per-call-site alternative histograms for `variant >> oxide::match{...}`.
+//
+// Enabled by defining OXIDE_PROFILE_DISPATCH for the whole program (the
+// OXIDE_PROFILE_DISPATCH CMake option does that for every oxide consumer).
+// A call site is identified by its matcher type; every match{...} expression
+// has a distinct type because its lambdas do. Each thread counts into
+// thread-local arrays that are merged when the thread exits, and the
+// histograms are printed to stderr from an atexit handler. The registry is
+// never destroyed, so threads that outlive the report still merge safely;
+// their counts just miss it.
+//
+// If OXIDE_PROFILE_HEADER names a file, a header of oxide::dispatch_order
+// specializations is written there too. Include it after oxide.hpp (or
+// `import oxide;`) and the Union types it names, in every TU that dispatches
+// on them, so operator>> tests the hot alternatives first.
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <source_location>
+#include <string_view>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace oxide::profile {
+    // Readable name of T, taken from the compiler's spelling of this function
+    template <typename T>
+    std::string_view type_name() {
+        const std::string_view name = std::source_location::current().function_name();
+#if defined(__clang__) || defined(__GNUC__)
+        const auto start = name.find("T = ") + 4;
+        const auto end = name.find_first_of(";]", start);
+#elif defined(_MSC_VER)
+        const auto start = name.find("type_name<") + 10;
+        const auto end = name.rfind(">(");
+#else
+        const std::size_t start = 0;
+        const auto end = name.size();
+#endif
+        return name.substr(start, end - start);
+    }
+
+    struct Site {
+        std::string_view variant;
+        std::string_view matcher;
+        std::vector<std::string_view> alternatives;
+        std::vector<std::atomic<std::uint64_t>> totals;
+
+        Site(const std::string_view variant_, const std::string_view matcher_, std::vector<std::string_view> alternatives_)
+            : variant(variant_), matcher(matcher_), alternatives(std::move(alternatives_)), totals(alternatives.size()) {}
+    };
+
+    // Alternatives worth testing first: most frequent first, until they cover
+    // 90% of calls (at most three), and only if the top one is a clear majority.
+    inline std::vector<std::size_t> hot_alternatives(const std::vector<std::uint64_t>& counts) {
+        const auto total = std::accumulate(counts.begin(), counts.end(), std::uint64_t{0});
+        std::vector<std::size_t> order(counts.size());
+        std::iota(order.begin(), order.end(), std::size_t{0});
+        std::ranges::stable_sort(order, [&](const std::size_t a, const std::size_t b) { return counts[a] > counts[b]; });
+
+        std::vector<std::size_t> hot;
+        if (total == 0 || counts[order.front()] * 2 < total) { return hot; }
+
+        std::uint64_t covered = 0;
+        for (const std::size_t i : order) {
+            if (counts[i] == 0 || hot.size() == 3 || covered * 10 >= total * 9) { break; }
+            hot.push_back(i);
+            covered += counts[i];
+        }
+        return hot;
+    }
+
+    class Registry {
+    public:
+        Registry() = default;
+        Registry(const Registry&) = delete;
+        Registry& operator=(const Registry&) = delete;
+
+        // Called at exit, after the main thread's thread_local counters have merged
+        void report() const {
+            dump(stderr);
+            if (const char* path = std::getenv("OXIDE_PROFILE_HEADER")) {
+                if (std::FILE* out = std::fopen(path, "w")) {
+                    write_header(out);
+                    std::fclose(out);
+                }
+            }
+        }
+
+        Site& add(const std::string_view variant, const std::string_view matcher, std::vector<std::string_view> alternatives) {
+            std::lock_guard lock(mutex_);
+            sites_.push_back(std::make_unique<Site>(variant, matcher, std::move(alternatives)));
+            return *sites_.back();
+        }
+
+        void dump(std::FILE* out) const {
+            std::lock_guard lock(mutex_);
+            for (std::size_t s = 0; s < sites_.size(); ++s) {
+                const Site& site = *sites_[s];
+                std::uint64_t total = 0;
+                for (const auto& count : site.totals) { total += count.load(std::memory_order_relaxed); }
+
+                std::fprintf(out, "oxide dispatch profile: site #%zu, %llu calls\n  union:   %.*s\n  matcher: %.*s\n",
+                             s, static_cast<unsigned long long>(total),
+                             static_cast<int>(site.variant.size()), site.variant.data(),
+                             static_cast<int>(site.matcher.size()), site.matcher.data());
+                for (std::size_t i = 0; i < site.alternatives.size(); ++i) {
+                    const auto count = site.totals[i].load(std::memory_order_relaxed);
+                    std::fprintf(out, "    [%zu] %-24.*s %12llu  %5.1f%%\n", i,
+                                 static_cast<int>(site.alternatives[i].size()), site.alternatives[i].data(),
+                                 static_cast<unsigned long long>(count),
+                                 total ? 100.0 * static_cast<double>(count) / static_cast<double>(total) : 0.0);
+                }
+            }
+        }
+
+        // dispatch_order is keyed by the Union type, so sites are summed per Union
+        void write_header(std::FILE* out) const {
+            std::lock_guard lock(mutex_);
+
+            std::map<std::string_view, std::pair<const Site*, std::vector<std::uint64_t>>> unions;
+            for (const auto& site : sites_) {
+                auto& [first, counts] = unions[site->variant];
+                if (first == nullptr) {
+                    first = site.get();
+                    counts.assign(site->totals.size(), 0);
+                }
+                for (std::size_t i = 0; i < counts.size(); ++i) {
+                    counts[i] += site->totals[i].load(std::memory_order_relaxed);
+                }
+            }
+
+            // No #include "oxide.hpp": it would clash with an `import oxide;` consumer
+            std::fprintf(out, "// Generated by an OXIDE_PROFILE_DISPATCH run. Include after oxide.hpp (or import oxide;)\n"
+                              "// and the Union types below are declared, in every translation unit that dispatches\n"
+                              "// on them. Module consumers include <array> and <cstddef> before the import.\n\n"
+                              "#ifndef OXIDE_DISPATCH_PROFILE_HPP\n#define OXIDE_DISPATCH_PROFILE_HPP\n\n"
+                              "#include <array>\n#include <cstddef>\n");
+
+            for (const auto& [variant, entry] : unions) {
+                const auto& [site, counts] = entry;
+                const auto hot = hot_alternatives(counts);
+                if (hot.empty()) { continue; }
+
+                const auto total = std::accumulate(counts.begin(), counts.end(), std::uint64_t{0});
+                std::fprintf(out, "\ntemplate <>\nstruct oxide::dispatch_order<%.*s> {\n",
+                             static_cast<int>(variant.size()), variant.data());
+                for (const std::size_t i : hot) {
+                    std::fprintf(out, "    // %.*s: %.1f%%\n",
+                                 static_cast<int>(site->alternatives[i].size()), site->alternatives[i].data(),
+                                 100.0 * static_cast<double>(counts[i]) / static_cast<double>(total));
+                }
+                std::fprintf(out, "    static constexpr std::array<std::size_t, %zu> hot{", hot.size());
+                for (std::size_t k = 0; k < hot.size(); ++k) {
+                    std::fprintf(out, "%s%zu", k ? ", " : "", hot[k]);
+                }
+                std::fprintf(out, "};\n};\n");
+            }
+
+            std::fprintf(out, "\n#endif // OXIDE_DISPATCH_PROFILE_HPP\n");
+        }
+
+    private:
+        mutable std::mutex mutex_;
+        std::vector<std::unique_ptr<Site>> sites_;
+    };
+
+    // Leaked on purpose: a thread exiting after the report still merges into
+    // its Site, so the sites must outlive every thread
+    inline Registry& registry() {
+        static Registry& instance = *[] {
+            auto* r = new Registry;
+            std::atexit([] { registry().report(); });
+            return r;
+        }();
+        return instance;
+    }
+
+    template <typename Variant, typename Matcher>
+    struct SiteCounters {
+        static constexpr std::size_t size = std::variant_size_v<Variant>;
+
+        // The Site is never freed (see registry()), so merging is safe at any time
+        SiteCounters() : site(&shared_site()) {}
+
+        ~SiteCounters() {
+            for (std::size_t i = 0; i < size; ++i) {
+                site->totals[i].fetch_add(counts[i], std::memory_order_relaxed);
+            }
+        }
+
+        static Site& shared_site() {
+            static Site& s = registry().add(type_name<Variant>(), type_name<Matcher>(), alternative_names());
+            return s;
+        }
+
+        static std::vector<std::string_view> alternative_names() {
+            return [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+                return std::vector<std::string_view>{type_name<std::variant_alternative_t<Is, Variant>>()...};
+            }(std::make_index_sequence<size>{});
+        }
+
+        Site* site;
+        std::uint64_t counts[size]{};
+    };
+
+    template <typename Variant, typename Matcher>
+    void record(const std::size_t index) {
+        thread_local SiteCounters<Variant, Matcher> local;
+        if (index < SiteCounters<Variant, Matcher>::size) { ++local.counts[index]; }
+    }
+}
+
+#endif // OXIDE_PROFILE_HPP
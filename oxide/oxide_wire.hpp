@@ -0,0 +1,302 @@
+/*
+    Copyright (C) 2025 Igal Alkon <igal@alkontek.com> and contributors
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef OXIDE_WIRE_HPP
+#define OXIDE_WIRE_HPP
+
+// Compact tagged binary encoding for oxide::Union values.
+//
+// Each value is written as a one-byte alternative index followed by the
+// alternative's payload. Integers are LEB128 varints (signed ones zigzagged),
+// strings are a varint length followed by the raw bytes. Alternatives opt in
+// by specializing oxide::wire::codec<T>:
+//
+//     template <> struct oxide::wire::codec<Write> {
+//         using view = WriteView;                       // what the decoder hands out
+//         static void encode(Encoder& e, const Write& w) { e.string(w.text); }
+//         static oxide::Option<view> decode(Cursor& c) { ... c.string() ... }
+//     };
+//
+// The Decoder walks a std::span<const std::byte> (e.g. a MappedFile) and hands
+// each value's view straight to a match{...}; views may borrow from the
+// buffer (a string payload decodes to a std::string_view), so replaying a
+// stream allocates nothing and never materializes the Union itself.
+
+#include <array>
+#include <cerrno>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <span>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if __has_include(<sys/mman.h>)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define OXIDE_WIRE_HAS_MMAP 1
+#endif
+
+#include "oxide.hpp"
+
+OXIDE_EXPORT namespace oxide::wire {
+    // Specialize for every alternative that should be serializable
+    template <typename T>
+    struct codec;
+
+    class Encoder;
+    class Cursor;
+
+    template <typename T>
+    concept Serializable = requires(Encoder& e, Cursor& c, const T& value) {
+        typename codec<T>::view;
+        codec<T>::encode(e, value);
+        { codec<T>::decode(c) } -> std::same_as<Option<typename codec<T>::view>>;
+    };
+
+    enum class Error {
+        truncated,  // the buffer ended inside a value
+        bad_tag,    // alternative index out of range for the Union
+        malformed,  // a codec rejected the payload
+    };
+
+    // Appends encoded values to a byte vector
+    class Encoder {
+    public:
+        explicit Encoder(std::vector<std::byte>& out) : out_(out) {}
+
+        void u8(const std::uint8_t value) {
+            out_.push_back(static_cast<std::byte>(value));
+        }
+
+        void varint(std::uint64_t value) {
+            while (value >= 0x80) {
+                u8(static_cast<std::uint8_t>(value | 0x80));
+                value >>= 7;
+            }
+            u8(static_cast<std::uint8_t>(value));
+        }
+
+        void zigzag(const std::int64_t value) {
+            varint((static_cast<std::uint64_t>(value) << 1) ^ static_cast<std::uint64_t>(value >> 63));
+        }
+
+        void string(const std::string_view value) {
+            varint(value.size());
+            const auto* bytes = reinterpret_cast<const std::byte*>(value.data());
+            out_.insert(out_.end(), bytes, bytes + value.size());
+        }
+
+    private:
+        std::vector<std::byte>& out_;
+    };
+
+    // Reads primitives from a borrowed buffer; never copies payload bytes
+    class Cursor {
+    public:
+        explicit Cursor(const std::span<const std::byte> data) : data_(data) {}
+
+        [[nodiscard]] bool empty() const { return pos_ == data_.size(); }
+        [[nodiscard]] std::size_t offset() const { return pos_; }
+        [[nodiscard]] bool overrun() const { return overrun_; }
+
+        Option<std::uint8_t> u8() {
+            if (pos_ == data_.size()) {
+                overrun_ = true;
+                return None;
+            }
+            return Some(static_cast<std::uint8_t>(data_[pos_++]));
+        }
+
+        Option<std::uint64_t> varint() {
+            std::uint64_t value = 0;
+            for (unsigned shift = 0; shift < 64; shift += 7) {
+                const auto byte = u8();
+                if (!byte) { return None; }
+                // The 10th byte holds only bit 63; anything above it is overlong or corrupt
+                if (shift == 63 && (*byte & 0x7Eu) != 0) { return None; }
+                value |= std::uint64_t{*byte & 0x7Fu} << shift;
+                if ((*byte & 0x80u) == 0) { return Some(value); }
+            }
+            return None; // more than 10 bytes
+        }
+
+        Option<std::int64_t> zigzag() {
+            return varint().transform([](const std::uint64_t v) {
+                return static_cast<std::int64_t>(v >> 1) ^ -static_cast<std::int64_t>(v & 1);
+            });
+        }
+
+        // Narrowing zigzag read; None if the value does not fit in Int
+        template <std::signed_integral Int>
+        Option<Int> zigzag_as() {
+            return zigzag().and_then([](const std::int64_t v) -> Option<Int> {
+                if (v < std::numeric_limits<Int>::min() || v > std::numeric_limits<Int>::max()) { return None; }
+                return Some(static_cast<Int>(v));
+            });
+        }
+
+        // A view into the buffer, valid for as long as the buffer is
+        Option<std::string_view> string() {
+            const auto size = varint();
+            if (!size) { return None; }
+            if (*size > data_.size() - pos_) {
+                overrun_ = true;
+                return None;
+            }
+            const std::string_view view(reinterpret_cast<const char*>(data_.data() + pos_), *size);
+            pos_ += *size;
+            return Some(view);
+        }
+
+    private:
+        std::span<const std::byte> data_;
+        std::size_t pos_ = 0;
+        bool overrun_ = false;
+    };
+
+    template <typename... Ts>
+        requires (Serializable<Ts> && ...)
+    void encode(Encoder& encoder, const Union<Ts...>& value) {
+        static_assert(sizeof...(Ts) <= 256, "alternative index must fit the one-byte tag");
+        encoder.u8(static_cast<std::uint8_t>(value.index()));
+        std::visit([&encoder]<typename T>(const T& alternative) {
+            codec<T>::encode(encoder, alternative);
+        }, value);
+    }
+
+    template <typename U>
+    class Decoder;
+
+    // Streams the Union values encoded in `data`, one view at a time
+    template <typename... Ts>
+        requires (Serializable<Ts> && ...)
+    class Decoder<Union<Ts...>> {
+    public:
+        explicit Decoder(const std::span<const std::byte> data) : cursor_(data) {}
+
+        [[nodiscard]] bool done() const { return cursor_.empty(); }
+        [[nodiscard]] std::size_t offset() const { return cursor_.offset(); }
+        // Start (tag byte) of the value next() last decoded or failed on; after an
+        // error offset() may point partway into it, so report this one instead
+        [[nodiscard]] std::size_t value_offset() const { return value_offset_; }
+
+        // Decodes the next value and calls `matcher` with codec<T>::view for its alternative
+        template <typename Matcher>
+        Result<void, Error> next(Matcher&& matcher) {
+            value_offset_ = cursor_.offset();
+            const auto tag = cursor_.u8();
+            if (!tag) { return std::unexpected(Error::truncated); }
+            if (*tag >= sizeof...(Ts)) { return std::unexpected(Error::bad_tag); }
+            return dispatch(*tag, matcher, std::index_sequence_for<Ts...>{});
+        }
+
+        // Decodes until the end of the buffer; returns how many values were visited
+        template <typename Matcher>
+        Result<std::size_t, Error> for_each(Matcher&& matcher) {
+            std::size_t count = 0;
+            while (!done()) {
+                if (auto result = next(matcher); !result) { return std::unexpected(result.error()); }
+                ++count;
+            }
+            return count;
+        }
+
+    private:
+        using Alternatives = Union<Ts...>;
+
+        template <std::size_t I, typename Matcher>
+        static Result<void, Error> decode_one(Cursor& cursor, Matcher& matcher) {
+            using T = std::variant_alternative_t<I, Alternatives>;
+            auto view = codec<T>::decode(cursor);
+            if (!view) { return std::unexpected(cursor.overrun() ? Error::truncated : Error::malformed); }
+            std::invoke(matcher, std::as_const(*view));
+            return {};
+        }
+
+        // One indirect call per value, like std::visit's table
+        template <typename Matcher, std::size_t... Is>
+        Result<void, Error> dispatch(const std::size_t tag, Matcher& matcher, std::index_sequence<Is...>) {
+            using Fn = Result<void, Error> (*)(Cursor&, Matcher&);
+            static constexpr std::array<Fn, sizeof...(Is)> table{&decode_one<Is, Matcher>...};
+            return table[tag](cursor_, matcher);
+        }
+
+        Cursor cursor_;
+        std::size_t value_offset_ = 0;
+    };
+
+#ifdef OXIDE_WIRE_HAS_MMAP
+    // Read-only mapping of a whole file, e.g. a message log to feed a Decoder
+    class MappedFile {
+    public:
+        explicit MappedFile(const std::string& path) {
+            const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+            if (fd < 0) { throw std::system_error(errno, std::generic_category(), "open " + path); }
+
+            struct stat st{};
+            if (::fstat(fd, &st) != 0) {
+                const int error = errno;
+                ::close(fd);
+                throw std::system_error(error, std::generic_category(), "fstat " + path);
+            }
+
+            size_ = static_cast<std::size_t>(st.st_size);
+            if (size_ > 0) {
+                void* base = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+                if (base == MAP_FAILED) {
+                    const int error = errno;
+                    ::close(fd);
+                    throw std::system_error(error, std::generic_category(), "mmap " + path);
+                }
+                ::madvise(base, size_, MADV_SEQUENTIAL);
+                data_ = static_cast<const std::byte*>(base);
+            }
+            ::close(fd);
+        }
+
+        ~MappedFile() {
+            if (data_ != nullptr) { ::munmap(const_cast<std::byte*>(data_), size_); }
+        }
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        [[nodiscard]] std::span<const std::byte> bytes() const { return {data_, size_}; }
+
+    private:
+        const std::byte* data_ = nullptr;
+        std::size_t size_ = 0;
+    };
+#endif
+}
+
+#endif // OXIDE_WIRE_HPP